@@ -0,0 +1,25 @@
+# tlk2cpp(<target> <name> <tlkfile>)
+#
+# Embeds <tlkfile> into <target> as a constant tlk::StaticView called <name>
+# (optionally namespace qualified, e.g. "game::Dialog"). The declaration is
+# available by including "<basename>.h", where <basename> is the unqualified
+# part of <name>. Requires the tlk2cpp and tlk_headers targets to be defined.
+function(tlk2cpp target name tlkfile)
+  string(REGEX REPLACE "^.*::" "" basename "${name}")
+  get_filename_component(tlkfile "${tlkfile}" ABSOLUTE)
+  set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/tlk2cpp/${target}")
+  set(header "${output_dir}/${basename}.h")
+  set(source "${output_dir}/${basename}.cpp")
+
+  add_custom_command(
+    OUTPUT "${header}" "${source}"
+    COMMAND ${CMAKE_COMMAND} -E make_directory "${output_dir}"
+    COMMAND tlk2cpp -n "${name}" "${tlkfile}" "${header}" "${source}"
+    DEPENDS tlk2cpp "${tlkfile}"
+    COMMENT "Embedding ${tlkfile} as ${name}"
+    VERBATIM)
+
+  target_sources(${target} PRIVATE "${header}" "${source}")
+  target_include_directories(${target} PRIVATE "${output_dir}")
+  target_link_libraries(${target} PRIVATE tlk_headers)
+endfunction()
@@ -0,0 +1,36 @@
+// MIT License
+//
+// Copyright (c) 2017 sylt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+
+#include "Hello.h"
+
+// Prints all entries of hello.tlk, which is embedded into the executable at
+// build time by tlk2cpp, so no TLK file is needed at runtime.
+int main()
+{
+  const auto& tlkFile = example::Hello;
+  for (uint32_t i = 0; i < tlkFile.GetStringCount(); i++) {
+    auto element = tlkFile.GetStringElement(i);
+    printf("#%u: %s\n", i, tlkFile.GetString(element).c_str());
+  }
+}
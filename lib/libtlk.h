@@ -98,6 +98,42 @@ inline const StringDataElement* FileView::GetStringElement(uint32_t index) const
     buffer + sizeof(*GetHeader()) + sizeof(StringDataElement) * index);
 }
 
+// Read-only view over TLK data compiled into the executable, as generated by
+// tlk2cpp. It mirrors the lookup API of FileView, but all data is constant
+// initialized, so no file has to be opened or mapped at runtime.
+class StaticView
+{
+public:
+  constexpr StaticView(const Header& header,
+                       const StringDataElement* elements,
+                       const char* strings)
+    : HeaderData(header), Elements(elements), Strings(strings) {}
+
+  const Header* GetHeader() const { return &HeaderData; }
+
+  uint32_t GetStringCount() const { return HeaderData.StringCount; }
+  const StringDataElement* GetStringElement(uint32_t index) const
+  {
+    return Elements + index;
+  }
+  std::string GetString(const StringDataElement* element) const
+  {
+    return {Strings + element->OffsetToString,
+            Strings + element->OffsetToString + element->StringSize};
+  }
+  std::tuple<const char*, uint32_t>
+  GetCString(const StringDataElement* element) const
+  {
+    return std::make_tuple(Strings + element->OffsetToString,
+                           element->StringSize);
+  }
+
+private:
+  Header HeaderData;
+  const StringDataElement* Elements;
+  const char* Strings;
+};
+
 class Builder
 {
 public:
@@ -0,0 +1,364 @@
+// MIT License
+//
+// Copyright (c) 2017 sylt
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "libtlk.h"
+
+const char USAGE[] =
+  "Usage: %s [OPTION]... tlkfile output.h output.cpp\n"
+  "\n"
+  "Generate C++ sources embedding a TLK file as a constant tlk::StaticView,\n"
+  "so it can be looked up without opening the file at runtime. Available\n"
+  "options are:\n"
+  "\n"
+  "  -n,--name=NAME      Name of the generated variable, optionally namespace\n"
+  "                      qualified (e.g. \"game::Dialog\"). Default is \"Dialog\".\n";
+
+// Bytes of the string pool emitted per line of generated source
+const size_t POOL_LINE_LENGTH = 64;
+
+static void PrintUsage(const char* programName)
+{
+  fprintf(stderr, USAGE, programName);
+}
+
+static std::vector<std::string> SplitQualifiedName(const std::string& name)
+{
+  std::vector<std::string> parts;
+  size_t begin = 0;
+  while (true) {
+    auto end = name.find("::", begin);
+    parts.emplace_back(name.substr(begin, end - begin));
+    if (end == std::string::npos) {
+      break;
+    }
+    begin = end + 2;
+  }
+
+  return parts;
+}
+
+static bool IsIdentifier(const std::string& str)
+{
+  if (str.empty() || (str[0] >= '0' && str[0] <= '9')) {
+    return false;
+  }
+
+  return std::all_of(str.begin(), str.end(), [](char c) {
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9');
+  });
+}
+
+static std::string BaseName(const std::string& path)
+{
+  auto pos = path.rfind('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+static std::string CharLiteral(char c)
+{
+  if (c >= 0x20 && c < 0x7f && c != '\'' && c != '\\') {
+    return {'\'', c, '\''};
+  }
+
+  char buffer[8];
+  snprintf(buffer, sizeof(buffer), "'\\%03o'", static_cast<uint8_t>(c));
+  return buffer;
+}
+
+static std::string FloatLiteral(float value)
+{
+  if (std::isnan(value)) {
+    return "std::numeric_limits<float>::quiet_NaN()";
+  }
+  if (std::isinf(value)) {
+    return value > 0 ? "std::numeric_limits<float>::infinity()"
+                     : "-std::numeric_limits<float>::infinity()";
+  }
+
+  // Nine significant digits round-trip any float. Hex floats would be exact
+  // too, but need C++17 to compile.
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.9g", value);
+  std::string literal = buffer;
+  if (literal.find_first_of(".e") == std::string::npos) {
+    literal += ".0"; // Integral values need a period to take an f suffix
+  }
+  return literal + 'f';
+}
+
+// Octal escapes are at most three digits long, so unlike hex escapes they
+// can't swallow a following character.
+static void WriteStringLiteral(std::ostream& out, const char* data, size_t size)
+{
+  out << '"';
+  for (size_t i = 0; i < size; i++) {
+    const auto c = static_cast<uint8_t>(data[i]);
+    switch (c) {
+    case '\n':
+      out << "\\n";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    case '"':
+    case '\\':
+    case '?': // Avoid trigraphs
+      out << '\\' << c;
+      break;
+    default:
+      if (c >= 0x20 && c < 0x7f) {
+        out << c;
+      } else {
+        char buffer[8];
+        snprintf(buffer, sizeof(buffer), "\\%03o", c);
+        out << buffer;
+      }
+    }
+  }
+  out << '"';
+}
+
+// FileView maps whole pages, so reading past the end of a truncated or
+// corrupt file wouldn't fault, and the garbage would end up embedded.
+static bool CheckBounds(const tlk::FileView& tlkFile, uint64_t fileSize)
+{
+  if (fileSize < sizeof(tlk::Header)) {
+    fprintf(stderr, "File is too small to contain a TLK header\n");
+    return false;
+  }
+
+  const auto header = tlkFile.GetHeader();
+  const uint64_t elementsEnd = sizeof(tlk::Header) +
+    static_cast<uint64_t>(header->StringCount) * sizeof(tlk::StringDataElement);
+  if (elementsEnd > fileSize) {
+    fprintf(stderr, "String count %u exceeds file size\n", header->StringCount);
+    return false;
+  }
+
+  for (uint32_t i = 0; i < header->StringCount; i++) {
+    auto element = tlkFile.GetStringElement(i);
+    const uint64_t stringEnd =
+      static_cast<uint64_t>(header->StringEntriesOffset) +
+      element->OffsetToString + element->StringSize;
+    if (stringEnd > fileSize) {
+      fprintf(stderr, "String of entry #%u exceeds file size\n", i);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void WriteHeader(std::ostream& out, const std::vector<std::string>& name)
+{
+  out << "// Generated by tlk2cpp, do not edit.\n"
+         "\n"
+         "#pragma once\n"
+         "\n"
+         "#include \"libtlk.h\"\n"
+         "\n";
+
+  for (size_t i = 0; i + 1 < name.size(); i++) {
+    out << "namespace " << name[i] << " {\n";
+  }
+  out << "extern const tlk::StaticView " << name.back() << ";\n";
+  for (size_t i = 0; i + 1 < name.size(); i++) {
+    out << "}\n";
+  }
+}
+
+static void WriteSource(std::ostream& out,
+                        const std::vector<std::string>& name,
+                        const std::string& headerName,
+                        const tlk::FileView& tlkFile)
+{
+  // Lay out the string pool the same way Builder does, so it only contains
+  // text that is actually referenced.
+  const auto stringCount = tlkFile.GetStringCount();
+  std::vector<tlk::StringDataElement> elements;
+  std::vector<char> text;
+  for (uint32_t i = 0; i < stringCount; i++) {
+    auto element = tlkFile.GetStringElement(i);
+    auto string = tlkFile.GetCString(element);
+    elements.emplace_back(*element);
+    elements.back().OffsetToString = text.size();
+    text.insert(text.end(), std::get<0>(string),
+                std::get<0>(string) + std::get<1>(string));
+  }
+
+  const auto header = tlkFile.GetHeader();
+
+  out << "// Generated by tlk2cpp, do not edit.\n"
+         "\n"
+         "#include <limits>\n"
+         "\n"
+         "#include \"" << headerName << "\"\n"
+         "\n";
+
+  for (size_t i = 0; i + 1 < name.size(); i++) {
+    out << "namespace " << name[i] << " {\n";
+  }
+
+  out << "\nnamespace {\n\n"
+         "constexpr tlk::StringDataElement Elements[" <<
+         std::max<size_t>(elements.size(), 1) << "] = {\n";
+  for (const auto& element : elements) {
+    out << "  {0x" << std::hex << element.Flags << std::dec << "u, {";
+    for (size_t i = 0; i < sizeof(element.SoundResRef); i++) {
+      out << (i > 0 ? ", " : "") << CharLiteral(element.SoundResRef[i]);
+    }
+    out << "}, " << element.VolumeVariance << "u, "
+        << element.PitchVariance << "u, "
+        << element.OffsetToString << "u, "
+        << element.StringSize << "u, "
+        << FloatLiteral(element.SoundLength) << "},\n";
+  }
+  out << "};\n"
+         "\n"
+         "constexpr char Strings[" << text.size() + 1 << "] =";
+  if (text.empty()) {
+    out << " \"\"";
+  }
+  for (size_t i = 0; i < text.size(); i += POOL_LINE_LENGTH) {
+    out << "\n  ";
+    WriteStringLiteral(out, text.data() + i,
+                       std::min(POOL_LINE_LENGTH, text.size() - i));
+  }
+  out << ";\n"
+         "\n"
+         "} // namespace\n"
+         "\n";
+
+  out << "constexpr tlk::StaticView " << name.back() << "(\n"
+         "  tlk::Header{\n"
+         "    {";
+  for (size_t i = 0; i < sizeof(header->FileType); i++) {
+    out << (i > 0 ? ", " : "") << CharLiteral(header->FileType[i]);
+  }
+  out << "},\n"
+         "    {";
+  for (size_t i = 0; i < sizeof(header->FileVersion); i++) {
+    out << (i > 0 ? ", " : "") << CharLiteral(header->FileVersion[i]);
+  }
+  out << "},\n"
+         "    " << header->LanguageId << "u,\n"
+         "    " << stringCount << "u,\n"
+         "    " << sizeof(tlk::Header) +
+                   elements.size() * sizeof(tlk::StringDataElement) << "u,\n"
+         "  },\n"
+         "  Elements,\n"
+         "  Strings);\n";
+
+  for (size_t i = 0; i + 1 < name.size(); i++) {
+    out << "}\n";
+  }
+}
+
+static bool WriteFile(const char* path, const std::string& contents)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << contents;
+  file.close();
+  if (!file) {
+    fprintf(stderr, "Couldn't write to file \"%s\"\n", path);
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  std::string name = "Dialog";
+
+  static const option longOptions[] = {
+    {"name", required_argument, nullptr, 'n'},
+    {nullptr, 0, nullptr, 0},
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "n:", longOptions, nullptr)) != -1) {
+    switch (opt) {
+    case 'n':
+      name = optarg;
+      break;
+    default:
+      PrintUsage(argv[0]);
+      return -1;
+    }
+  }
+
+  if (argc - optind != 3) {
+    fprintf(stderr, "Expected three arguments after options\n");
+    PrintUsage(argv[0]);
+    return -1;
+  }
+
+  auto qualifiedName = SplitQualifiedName(name);
+  for (const auto& part : qualifiedName) {
+    if (!IsIdentifier(part)) {
+      fprintf(stderr, "Invalid name \"%s\"\n", name.c_str());
+      return -1;
+    }
+  }
+
+  const char* tlkPath = argv[optind];
+  struct stat buf;
+  if (stat(tlkPath, &buf) == -1) {
+    fprintf(stderr, "Couldn't stat file \"%s\": %s\n",
+            tlkPath, strerror(errno));
+    return -1;
+  }
+
+  tlk::FileView tlkFile(tlkPath);
+  if (!CheckBounds(tlkFile, buf.st_size)) {
+    fprintf(stderr, "Invalid TLK file \"%s\"\n", tlkPath);
+    return -1;
+  }
+
+  const char* headerPath = argv[optind + 1];
+  const char* sourcePath = argv[optind + 2];
+
+  std::ostringstream header;
+  WriteHeader(header, qualifiedName);
+
+  std::ostringstream source;
+  WriteSource(source, qualifiedName, BaseName(headerPath), tlkFile);
+
+  if (!WriteFile(headerPath, header.str()) ||
+      !WriteFile(sourcePath, source.str())) {
+    return -1;
+  }
+}